@@ -30,6 +30,9 @@ public class OpenAITexGenSlateTool : ModuleRules
 			new string[]
 			{
 				"Core",
+				"CoreUObject",
+				"Engine",
+				"Json",
 			}
 		);
 
@@ -42,13 +45,10 @@ public class OpenAITexGenSlateTool : ModuleRules
 				"EditorFramework",
 				"UnrealEd",
 				"ToolMenus",
-				"CoreUObject",
-				"Engine",
 				"Slate",
 				"SlateCore",
 				"WorkspaceMenuStructure",
 				"HTTP",
-				"Json",
 				"JsonUtilities",
 				"DeveloperSettings",
 				"AssetRegistry"
@@ -21,21 +21,28 @@
 
 #include "OpenAITexGenSlateTool.h"
 #include "HttpModule.h"
+#include "Async/Async.h"
 #include "IImageWrapper.h"
 #include "IImageWrapperModule.h"
 #include "ImageUtils.h"
 #include "SOpenAITexGenSlateToolWindowWidget.h"
 #include "OpenAITexGenSlateToolSettings.h"
+#include "OpenAITexGenSlateToolJob.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Text/STextBlock.h"
 #include "ToolMenus.h"
+#include "Algo/Find.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Texture2D.h"
 #include "Framework/Notifications/NotificationManager.h"
 #include "Interfaces/IHttpResponse.h"
+#include "Misc/PackageName.h"
 #include "Serialization/JsonSerializerMacros.h"
 #include "Widgets/Notifications/SNotificationList.h"
 
 static const FName OpenAITexGenSlateToolName("OpenAITexGenSlateTool");
+// Sizes accepted by the images/generations endpoint
+static const TCHAR* DallEImageSizes[] = { TEXT("256x256"), TEXT("512x512"), TEXT("1024x1024") };
 
 #define LOCTEXT_NAMESPACE "OpenAITexGenSlateTool"
 
@@ -49,6 +56,28 @@ namespace
 		Info.Image = FAppStyle::GetBrush(!bIsSuccess ? "NotificationList.FailImage" : "NotificationList.SuccessImage");
 		FSlateNotificationManager::Get().AddNotification(Info);	
 	}
+
+	UTexture2D* CreateTextureAsset(const FString& PackagePath, const FString& TextureName, int32 Width, int32 Height, const TArray<FColor>& SrcData)
+	{
+		const FString PackageName = PackagePath / TextureName;
+		UPackage* Package = CreatePackage(*PackageName);
+		if (!Package)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Package creation failed!"));
+			return nullptr;
+		}
+		Package->FullyLoad();
+
+		UTexture2D* NewTexture = FImageUtils::CreateTexture2D(Width, Height, SrcData, Package, TextureName, RF_Public | RF_Standalone | RF_MarkAsRootSet, FCreateTexture2DParameters{});
+		if (!NewTexture)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("2D Texture creation failed!"));
+			return nullptr;
+		}
+		FAssetRegistryModule::AssetCreated(NewTexture);
+
+		return NewTexture;
+	}
 }
 
 void FOpenAITexGenSlateToolModule::StartupModule()
@@ -79,6 +108,109 @@ void FOpenAITexGenSlateToolModule::ShutdownModule()
 	}	
 }
 
+FOpenAITexGenSlateToolModule& FOpenAITexGenSlateToolModule::Get()
+{
+	return FModuleManager::LoadModuleChecked<FOpenAITexGenSlateToolModule>(OpenAITexGenSlateToolName);
+}
+
+UOpenAITexGenSlateToolJob* FOpenAITexGenSlateToolModule::SubmitJob(const FDallEPrompt& DallEPrompt, const FString& PackagePath, const FString& TextureName)
+{
+	check(IsInGameThread());
+
+	UOpenAITexGenSlateToolJob* Job = NewObject<UOpenAITexGenSlateToolJob>();
+	Job->DallEPrompt = DallEPrompt;
+	Job->PackagePath = PackagePath;
+	Job->TextureName = TextureName;
+	// Unrooted by the job itself once it finishes
+	Job->AddToRoot();
+
+	// Reject bad requests up front, before a paid API request is made for them
+	FString ErrorMessage = ValidateJob(DallEPrompt, PackagePath, TextureName);
+	if (ErrorMessage.IsEmpty())
+	{
+		const FString AssetPath = Job->GetAssetPath();
+		InFlightAssetPaths.Add(AssetPath);
+		Job->OnCompletedNative.AddLambda([this, AssetPath](UOpenAITexGenSlateToolJob*)
+		{
+			InFlightAssetPaths.Remove(AssetPath);
+		});
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s"), *ErrorMessage);
+	}
+
+	// Start on the next tick so the caller can bind to the job's delegates before anything is broadcast
+	AsyncTask(ENamedThreads::GameThread, [this, WeakJob = MakeWeakObjectPtr(Job), ErrorMessage = MoveTemp(ErrorMessage)]()
+	{
+		UOpenAITexGenSlateToolJob* QueuedJob = WeakJob.Get();
+		if (!QueuedJob)
+		{
+			return;
+		}
+
+		if (!ErrorMessage.IsEmpty())
+		{
+			QueuedJob->Finish(nullptr, ErrorMessage);
+			return;
+		}
+
+		PostDallEHttpRequest(QueuedJob);
+	});
+	
+	return Job;
+}
+
+FString FOpenAITexGenSlateToolModule::ValidateJob(const FDallEPrompt& DallEPrompt, const FString& PackagePath, const FString& TextureName) const
+{
+	if (!Algo::Find(DallEImageSizes, DallEPrompt.ImageSize))
+	{
+		return FString::Printf(TEXT("Invalid image size '%s'. Supported sizes are %s"), *DallEPrompt.ImageSize, *FString::Join(DallEImageSizes, TEXT(", ")));
+	}
+	
+	FText Reason;
+	if (TextureName.IsEmpty() || !FName(*TextureName).IsValidObjectName(&Reason))
+	{
+		return FString::Printf(TEXT("Invalid texture name '%s'. %s"), *TextureName, *Reason.ToString());
+	}
+
+	const FString AssetPath = PackagePath / TextureName;
+	if (!FPackageName::IsValidLongPackageName(AssetPath, false, &Reason))
+	{
+		return FString::Printf(TEXT("Invalid texture path '%s'. %s"), *AssetPath, *Reason.ToString());
+	}
+
+	if (InFlightAssetPaths.Contains(AssetPath))
+	{
+		return FString::Printf(TEXT("A texture is already being generated at '%s'"), *AssetPath);
+	}
+
+	// Creating the texture over an object of another class is fatal, so catch it before the request rather than after
+	const FString ObjectPath = AssetPath + TEXT(".") + TextureName;
+	if (const UObject* ExistingObject = StaticFindObject(UObject::StaticClass(), nullptr, *ObjectPath))
+	{
+		if (!ExistingObject->IsA<UTexture2D>())
+		{
+			return FString::Printf(TEXT("'%s' already exists as a %s"), *AssetPath, *ExistingObject->GetClass()->GetName());
+		}
+	}
+	else
+	{
+		TArray<FAssetData> ExistingAssets;
+		IAssetRegistry::GetChecked().GetAssetsByPackageName(FName(*AssetPath), ExistingAssets);
+		for (const FAssetData& ExistingAsset : ExistingAssets)
+		{
+			const UClass* AssetClass = ExistingAsset.GetClass();
+			if (!AssetClass || !AssetClass->IsChildOf<UTexture2D>())
+			{
+				return FString::Printf(TEXT("'%s' already exists and is not a texture"), *AssetPath);
+			}
+		}
+	}
+
+	return FString();
+}
+
 void FOpenAITexGenSlateToolModule::OnSpawnWindow()
 {
 	if (MainWindow)
@@ -104,120 +236,135 @@ void FOpenAITexGenSlateToolModule::OnSpawnWindow()
 	FSlateApplication::Get().AddWindow(MainWindow.ToSharedRef());	
 }
 
-void FOpenAITexGenSlateToolModule::PostDallEHttpRequest(const FDallEPrompt& DallEPrompt)
+void FOpenAITexGenSlateToolModule::PostDallEHttpRequest(UOpenAITexGenSlateToolJob* Job)
 {
-	TextureGeneratorWindowWidget->SetLoading(true);
+	Job->SetState(EOpenAITexGenSlateToolJobState::RequestingImage);
 	const TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
 
-	HttpRequest->OnProcessRequestComplete().BindRaw(this, &FOpenAITexGenSlateToolModule::OnAPIRequestComplete);
+	HttpRequest->OnProcessRequestComplete().BindRaw(this, &FOpenAITexGenSlateToolModule::OnAPIRequestComplete, MakeWeakObjectPtr(Job));
 	HttpRequest->SetVerb(TEXT("POST"));
 
 	HttpRequest->SetURL(TEXT("https://api.openai.com/v1/images/generations"));
 	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
 	HttpRequest->SetHeader(TEXT("Authorization"), TEXT("Bearer ") + GetDefault<UOpenAITexGenSlateToolSettings>()->ApiKey);
 	
-	HttpRequest->SetContentAsString(DallEPrompt.ToJson());
+	HttpRequest->SetContentAsString(Job->DallEPrompt.ToJson());
 	
 	HttpRequest->ProcessRequest();
 }
 
-void FOpenAITexGenSlateToolModule::GetImageDownloadHttpRequest(const FString& Url)
+void FOpenAITexGenSlateToolModule::GetImageDownloadHttpRequest(UOpenAITexGenSlateToolJob* Job, const FString& Url)
 {
+	Job->SetState(EOpenAITexGenSlateToolJobState::DownloadingImage);
 	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
 	
-	HttpRequest->OnProcessRequestComplete().BindRaw(this, &FOpenAITexGenSlateToolModule::OnImageDownloadComplete);
+	HttpRequest->OnProcessRequestComplete().BindRaw(this, &FOpenAITexGenSlateToolModule::OnImageDownloadComplete, MakeWeakObjectPtr(Job));
 	HttpRequest->SetVerb(TEXT("GET"));
 	HttpRequest->SetURL(Url);
 	HttpRequest->ProcessRequest();
 }
 
-void FOpenAITexGenSlateToolModule::OnAPIRequestComplete(FHttpRequestPtr /*Request*/, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+void FOpenAITexGenSlateToolModule::OnAPIRequestComplete(FHttpRequestPtr /*Request*/, FHttpResponsePtr Response, bool bConnectedSuccessfully, TWeakObjectPtr<UOpenAITexGenSlateToolJob> Job)
 {
-	if(!bConnectedSuccessfully || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+	if (!Job.IsValid())
 	{
-		TextureGeneratorWindowWidget->SetLoading(false);
-		ShowNotification("Texture Generation Failed", false);
-		if(Response->GetResponseCode() == 400)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Not enough DALL-E credits for request"));
-		}
-		else
+		return;
+	}
+	
+	if(!bConnectedSuccessfully || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+	{
+		FString ErrorMessage = TEXT("Api request failed");
+		FDallEErrorResponse DallEErrorResponse;
+		if(Response.IsValid() && DallEErrorResponse.FromJson(Response->GetContentAsString()) && !DallEErrorResponse.Error.Message.IsEmpty())
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Api request failed"));
+			ErrorMessage = FString::Printf(TEXT("Api request failed (%d): %s"), Response->GetResponseCode(), *DallEErrorResponse.Error.Message);
 		}
+		
+		UE_LOG(LogTemp, Warning, TEXT("%s"), *ErrorMessage);
+		Job->Finish(nullptr, ErrorMessage);
 		return;
 	}
 	
 	FDallEResponse DallEResponse;
 	if(!DallEResponse.FromJson(Response->GetContentAsString()) || DallEResponse.UrlArray.IsEmpty())
 	{
-		TextureGeneratorWindowWidget->SetLoading(false);
-		ShowNotification("Texture Generation Failed", false);
 		UE_LOG(LogTemp, Warning, TEXT("Response couldn't parse"));
+		Job->Finish(nullptr, TEXT("Response couldn't parse"));
 		return;
 	}	
 
-	GetImageDownloadHttpRequest(DallEResponse.UrlArray[0].Url);
+	GetImageDownloadHttpRequest(Job.Get(), DallEResponse.UrlArray[0].Url);
 }
 
-bool FOpenAITexGenSlateToolModule::TryCreateTextureFromPngData(const TArray<uint8>& PngData) const
+void FOpenAITexGenSlateToolModule::CreateTextureFromPngData(UOpenAITexGenSlateToolJob* Job, const TArray<uint8>& PngData) const
 {
+	Job->SetState(EOpenAITexGenSlateToolJobState::CreatingTexture);
+	
 	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
 	const TSharedPtr<IImageWrapper> PngImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
 
 	if (!(PngImageWrapper.IsValid() && PngImageWrapper->SetCompressed(PngData.GetData(), PngData.Num())))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Png Image Wrapper is not valid!"));
-		return false;	
+		Job->Finish(nullptr, TEXT("Png Image Wrapper is not valid!"));
+		return;	
 	}
-	
-	TArray64<uint8> RawImageData;
-	if (PngImageWrapper->GetRaw(ERGBFormat::RGBA, 8, RawImageData))
+
+	// Decoding is the expensive part of the pipeline, keep it off the game thread so queued jobs don't stall the editor.
+	// Only the package and texture creation has to happen back on the game thread.
+	Async(EAsyncExecution::ThreadPool, [PngImageWrapper, WeakJob = MakeWeakObjectPtr(Job)]()
 	{
+		TArray64<uint8> RawImageData;
+		const bool bDecoded = PngImageWrapper->GetRaw(ERGBFormat::RGBA, 8, RawImageData);
 		const int32 Width = PngImageWrapper->GetWidth();
 		const int32 Height = PngImageWrapper->GetHeight();
 
 		TArray<FColor> SrcData;
-		for(int32 Index = 0; Index < RawImageData.Num(); Index += 4)
-		{
-			SrcData.Add(FColor(RawImageData[Index], RawImageData[Index + 1], RawImageData[Index + 2], RawImageData[Index + 3]));
-		}
-
-		FString PackageName = TextureGeneratorWindowWidget->GetTexturePath();
-		const FString TextureName = TextureGeneratorWindowWidget->GetTextureName();
-		PackageName = PackageName / TextureName;
-		UPackage* Package = CreatePackage(*PackageName);
-		if (!Package)
+		if (bDecoded)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Package creation failed!"));
-			ShowNotification("Texture Generation Failed", false);
-			return false;
+			SrcData.Reserve(RawImageData.Num() / 4);
+			for(int32 Index = 0; Index < RawImageData.Num(); Index += 4)
+			{
+				SrcData.Add(FColor(RawImageData[Index], RawImageData[Index + 1], RawImageData[Index + 2], RawImageData[Index + 3]));
+			}
 		}
-		Package->FullyLoad();
 
-		UTexture2D* NewTexture = FImageUtils::CreateTexture2D(Width, Height, SrcData, Package, TextureName, RF_Public | RF_Standalone | RF_MarkAsRootSet, FCreateTexture2DParameters{});
-		if (!NewTexture)
+		AsyncTask(ENamedThreads::GameThread, [WeakJob, bDecoded, Width, Height, SrcData = MoveTemp(SrcData)]()
 		{
-			UE_LOG(LogTemp, Warning, TEXT("2D Texture creation failed!"));
-			ShowNotification("Texture Generation Failed", false);
-			return false;
-		}
-		FAssetRegistryModule::AssetCreated(NewTexture);
+			UOpenAITexGenSlateToolJob* Job = WeakJob.Get();
+			if (!Job)
+			{
+				return;
+			}
 
-		return true;
-	}
+			if (!bDecoded)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Png data couldn't decode!"));
+				Job->Finish(nullptr, TEXT("Png data couldn't decode!"));
+				return;
+			}
 
-	return false;
+			UTexture2D* NewTexture = CreateTextureAsset(Job->GetPackagePath(), Job->GetTextureName(), Width, Height, SrcData);
+			if (!NewTexture)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Texture creation failed!"));
+			}
+			Job->Finish(NewTexture, NewTexture ? FString() : FString(TEXT("Texture creation failed!")));
+		});
+	});
 }
 
-void FOpenAITexGenSlateToolModule::OnImageDownloadComplete(FHttpRequestPtr /*Request*/, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+void FOpenAITexGenSlateToolModule::OnImageDownloadComplete(FHttpRequestPtr /*Request*/, FHttpResponsePtr Response, bool bConnectedSuccessfully, TWeakObjectPtr<UOpenAITexGenSlateToolJob> Job)
 {
-	ON_SCOPE_EXIT { TextureGeneratorWindowWidget->SetLoading(false); };
+	if (!Job.IsValid())
+	{
+		return;
+	}
 	
-	if(!bConnectedSuccessfully || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+	if(!bConnectedSuccessfully || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Api request failed"));
-		ShowNotification("Texture Generation Failed", false);
+		Job->Finish(nullptr, TEXT("Image download failed"));
 		return;
 	}
 
@@ -225,17 +372,11 @@ void FOpenAITexGenSlateToolModule::OnImageDownloadComplete(FHttpRequestPtr /*Req
 	if (PngData.IsEmpty())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Png data is empty!"));
-		ShowNotification("Texture Generation Failed", false);
+		Job->Finish(nullptr, TEXT("Png data is empty!"));
 		return;	
 	}
 
-	if(!TryCreateTextureFromPngData(PngData))
-	{
-		ShowNotification("Texture Generation Failed", false);
-		UE_LOG(LogTemp, Warning, TEXT("Texture creation failed!"));
-	}
-
-	ShowNotification(FString::Printf(TEXT("Texture Successfully Generated at %s"), *(TextureGeneratorWindowWidget->GetTexturePath() / TextureGeneratorWindowWidget->GetTextureName())) , true);
+	CreateTextureFromPngData(Job.Get(), PngData);
 }
 
 void FOpenAITexGenSlateToolModule::OnGenerateClicked()
@@ -244,7 +385,22 @@ void FOpenAITexGenSlateToolModule::OnGenerateClicked()
 	DallEPrompt.Prompt = TextureGeneratorWindowWidget->GetTexturePrompt();
 	DallEPrompt.ImageSize = TextureGeneratorWindowWidget->GetTextureSize();
 
-	PostDallEHttpRequest(DallEPrompt);
+	TextureGeneratorWindowWidget->SetLoading(true);
+	UOpenAITexGenSlateToolJob* Job = SubmitJob(DallEPrompt, TextureGeneratorWindowWidget->GetTexturePath(), TextureGeneratorWindowWidget->GetTextureName());
+	Job->OnCompletedNative.AddRaw(this, &FOpenAITexGenSlateToolModule::OnGenerateJobCompleted);
+}
+
+void FOpenAITexGenSlateToolModule::OnGenerateJobCompleted(UOpenAITexGenSlateToolJob* Job)
+{
+	TextureGeneratorWindowWidget->SetLoading(false);
+	
+	if (Job->GetState() != EOpenAITexGenSlateToolJobState::Succeeded)
+	{
+		ShowNotification(FString::Printf(TEXT("Texture Generation Failed: %s"), *Job->GetErrorMessage()), false);
+		return;
+	}
+
+	ShowNotification(FString::Printf(TEXT("Texture Successfully Generated at %s"), *Job->GetAssetPath()), true);
 }
 
 #undef LOCTEXT_NAMESPACE
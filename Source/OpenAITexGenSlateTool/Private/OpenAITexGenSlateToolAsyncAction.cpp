@@ -0,0 +1,71 @@
+/*
+* Copyright (C) 2023 Akın Kürşat Özkan <akinkursatozkan@gmail.com>
+ * 
+ * This file is part of OpenAITexGenSlateTool
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the MIT License as published by
+ * the Open Source Initiative, either version 1.0 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * MIT License for more details.
+ * 
+ * You should have received a copy of the MIT License
+ * along with this program. If not, see <https://opensource.org/licenses/MIT>.
+ *
+ * Source code on GitHub: https://github.com/aknkrstozkn/OpenAITexGenSlateTool
+ */
+
+#include "OpenAITexGenSlateToolAsyncAction.h"
+#include "OpenAITexGenSlateTool.h"
+#include "OpenAITexGenSlateToolJob.h"
+
+UOpenAITexGenSlateToolAsyncAction* UOpenAITexGenSlateToolAsyncAction::GenerateTextureAsync(const FString& Prompt, const FString& TextureName, const FString& ImageSize, const FString& PackagePath)
+{
+	UOpenAITexGenSlateToolAsyncAction* Action = NewObject<UOpenAITexGenSlateToolAsyncAction>();
+	Action->Prompt = Prompt;
+	Action->TextureName = TextureName;
+	Action->ImageSize = ImageSize;
+	Action->PackagePath = PackagePath;
+	return Action;
+}
+
+void UOpenAITexGenSlateToolAsyncAction::Activate()
+{
+	// Editor utilities usually run without a game instance to register with, so keep ourselves alive until the job ends
+	AddToRoot();
+
+	FDallEPrompt DallEPrompt;
+	DallEPrompt.Prompt = Prompt;
+	DallEPrompt.ImageSize = ImageSize;
+
+	Job = FOpenAITexGenSlateToolModule::Get().SubmitJob(DallEPrompt, PackagePath, TextureName);
+	Job->OnProgressNative.AddUObject(this, &UOpenAITexGenSlateToolAsyncAction::OnJobProgress);
+	Job->OnCompletedNative.AddUObject(this, &UOpenAITexGenSlateToolAsyncAction::OnJobCompleted);
+}
+
+void UOpenAITexGenSlateToolAsyncAction::OnJobProgress(UOpenAITexGenSlateToolJob* InJob)
+{
+	if (!InJob->IsFinished())
+	{
+		OnProgress.Broadcast(InJob, nullptr, InJob->GetProgress(), FString());
+	}
+}
+
+void UOpenAITexGenSlateToolAsyncAction::OnJobCompleted(UOpenAITexGenSlateToolJob* InJob)
+{
+	if (UTexture2D* Texture = InJob->GetTexture())
+	{
+		OnSucceeded.Broadcast(InJob, Texture, 1.f, FString());
+	}
+	else
+	{
+		OnFailed.Broadcast(InJob, nullptr, 1.f, InJob->GetErrorMessage());
+	}
+
+	RemoveFromRoot();
+	SetReadyToDestroy();
+}
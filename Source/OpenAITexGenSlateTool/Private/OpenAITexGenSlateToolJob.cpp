@@ -0,0 +1,69 @@
+/*
+* Copyright (C) 2023 Akın Kürşat Özkan <akinkursatozkan@gmail.com>
+ * 
+ * This file is part of OpenAITexGenSlateTool
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the MIT License as published by
+ * the Open Source Initiative, either version 1.0 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * MIT License for more details.
+ * 
+ * You should have received a copy of the MIT License
+ * along with this program. If not, see <https://opensource.org/licenses/MIT>.
+ *
+ * Source code on GitHub: https://github.com/aknkrstozkn/OpenAITexGenSlateTool
+ */
+
+#include "OpenAITexGenSlateToolJob.h"
+#include "Engine/Texture2D.h"
+
+float UOpenAITexGenSlateToolJob::GetProgress() const
+{
+	switch (State)
+	{
+	case EOpenAITexGenSlateToolJobState::Queued:
+		return 0.f;
+	case EOpenAITexGenSlateToolJobState::RequestingImage:
+		return 0.1f;
+	case EOpenAITexGenSlateToolJobState::DownloadingImage:
+		return 0.6f;
+	case EOpenAITexGenSlateToolJobState::CreatingTexture:
+		return 0.9f;
+	default:
+		return 1.f;
+	}
+}
+
+void UOpenAITexGenSlateToolJob::SetState(EOpenAITexGenSlateToolJobState NewState)
+{
+	if (State == NewState || IsFinished())
+	{
+		return;
+	}
+
+	State = NewState;
+	OnProgressNative.Broadcast(this);
+	OnProgress.Broadcast(this, State, GetProgress());
+}
+
+void UOpenAITexGenSlateToolJob::Finish(UTexture2D* InTexture, const FString& InErrorMessage)
+{
+	if (IsFinished())
+	{
+		return;
+	}
+
+	Texture = InTexture;
+	ErrorMessage = InErrorMessage;
+	SetState(Texture ? EOpenAITexGenSlateToolJobState::Succeeded : EOpenAITexGenSlateToolJobState::Failed);
+
+	// Broadcast before unrooting so listeners can still safely grab the handle
+	OnCompletedNative.Broadcast(this);
+	OnCompleted.Broadcast(this, Texture != nullptr, Texture);
+	RemoveFromRoot();
+}
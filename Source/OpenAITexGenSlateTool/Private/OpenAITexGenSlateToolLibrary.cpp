@@ -0,0 +1,32 @@
+/*
+* Copyright (C) 2023 Akın Kürşat Özkan <akinkursatozkan@gmail.com>
+ * 
+ * This file is part of OpenAITexGenSlateTool
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the MIT License as published by
+ * the Open Source Initiative, either version 1.0 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * MIT License for more details.
+ * 
+ * You should have received a copy of the MIT License
+ * along with this program. If not, see <https://opensource.org/licenses/MIT>.
+ *
+ * Source code on GitHub: https://github.com/aknkrstozkn/OpenAITexGenSlateTool
+ */
+
+#include "OpenAITexGenSlateToolLibrary.h"
+#include "OpenAITexGenSlateTool.h"
+
+UOpenAITexGenSlateToolJob* UOpenAITexGenSlateToolLibrary::SubmitTextureGeneration(const FString& Prompt, const FString& TextureName, const FString& ImageSize, const FString& PackagePath)
+{
+	FDallEPrompt DallEPrompt;
+	DallEPrompt.Prompt = Prompt;
+	DallEPrompt.ImageSize = ImageSize;
+
+	return FOpenAITexGenSlateToolModule::Get().SubmitJob(DallEPrompt, PackagePath, TextureName);
+}
@@ -29,24 +29,37 @@
 class SMultiLineEditableTextBox;
 class SEditableTextBox;
 class SOpenAITexGenSlateToolWindowWidget;
+class UOpenAITexGenSlateToolJob;
 
-class FOpenAITexGenSlateToolModule : public IModuleInterface
+class OPENAITEXGENSLATETOOL_API FOpenAITexGenSlateToolModule : public IModuleInterface
 {
 public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+	static FOpenAITexGenSlateToolModule& Get();
+
+	/**
+	 * Creates a job in the Queued state and returns immediately, the pipeline starts on the next game thread tick.
+	 * Invalid image sizes and invalid, in-flight or conflicting asset paths fail the job on that tick without sending any request.
+	 */
+	UOpenAITexGenSlateToolJob* SubmitJob(const FDallEPrompt& DallEPrompt, const FString& PackagePath, const FString& TextureName);
 	
 private:
-	void OnImageDownloadComplete(FHttpRequestPtr /*Request*/, FHttpResponsePtr /*Response*/, bool /*bConnectedSuccessfully*/);
-	void OnAPIRequestComplete(FHttpRequestPtr /*Request*/, FHttpResponsePtr /*Response*/, bool /*bConnectedSuccessfully*/);
+	void OnImageDownloadComplete(FHttpRequestPtr /*Request*/, FHttpResponsePtr /*Response*/, bool /*bConnectedSuccessfully*/, TWeakObjectPtr<UOpenAITexGenSlateToolJob> Job);
+	void OnAPIRequestComplete(FHttpRequestPtr /*Request*/, FHttpResponsePtr /*Response*/, bool /*bConnectedSuccessfully*/, TWeakObjectPtr<UOpenAITexGenSlateToolJob> Job);
 	
-	bool TryCreateTextureFromPngData(const TArray<uint8>& PngData) const;
-	void PostDallEHttpRequest(const FDallEPrompt& DallEPrompt);
-	void GetImageDownloadHttpRequest(const FString& Url);
+	void CreateTextureFromPngData(UOpenAITexGenSlateToolJob* Job, const TArray<uint8>& PngData) const;
+	void PostDallEHttpRequest(UOpenAITexGenSlateToolJob* Job);
+	void GetImageDownloadHttpRequest(UOpenAITexGenSlateToolJob* Job, const FString& Url);
+
+	FString ValidateJob(const FDallEPrompt& DallEPrompt, const FString& PackagePath, const FString& TextureName) const;
 
 	void OnGenerateClicked();
+	void OnGenerateJobCompleted(UOpenAITexGenSlateToolJob* Job);
 	void OnSpawnWindow();
 
 	TSharedPtr<SWindow> MainWindow;
 	TSharedPtr<SOpenAITexGenSlateToolWindowWidget> TextureGeneratorWindowWidget;
+	TSet<FString> InFlightAssetPaths;
 };
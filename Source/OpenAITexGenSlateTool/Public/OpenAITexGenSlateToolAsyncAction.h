@@ -0,0 +1,65 @@
+/*
+* Copyright (C) 2023 Akın Kürşat Özkan <akinkursatozkan@gmail.com>
+ * 
+ * This file is part of OpenAITexGenSlateTool
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the MIT License as published by
+ * the Open Source Initiative, either version 1.0 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * MIT License for more details.
+ * 
+ * You should have received a copy of the MIT License
+ * along with this program. If not, see <https://opensource.org/licenses/MIT>.
+ *
+ * Source code on GitHub: https://github.com/aknkrstozkn/OpenAITexGenSlateTool
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "OpenAITexGenSlateToolAsyncAction.generated.h"
+
+class UTexture2D;
+class UOpenAITexGenSlateToolJob;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOpenAITexGenSlateToolAsyncActionPin, UOpenAITexGenSlateToolJob*, Job, UTexture2D*, Texture, float, Progress, const FString&, ErrorMessage);
+
+/** Latent Blueprint node that drives a texture generation on the module pipeline without blocking the editor. */
+UCLASS()
+class OPENAITEXGENSLATETOOL_API UOpenAITexGenSlateToolAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FOpenAITexGenSlateToolAsyncActionPin OnProgress;
+
+	UPROPERTY(BlueprintAssignable)
+	FOpenAITexGenSlateToolAsyncActionPin OnSucceeded;
+
+	UPROPERTY(BlueprintAssignable)
+	FOpenAITexGenSlateToolAsyncActionPin OnFailed;
+
+	UFUNCTION(BlueprintCallable, Category = TextureGenerator, meta = (BlueprintInternalUseOnly = "true", DisplayName = "Generate Texture Async"))
+	static UOpenAITexGenSlateToolAsyncAction* GenerateTextureAsync(const FString& Prompt, const FString& TextureName, const FString& ImageSize = TEXT("1024x1024"), const FString& PackagePath = TEXT("/Game"));
+
+	virtual void Activate() override;
+
+private:
+	void OnJobProgress(UOpenAITexGenSlateToolJob* InJob);
+	void OnJobCompleted(UOpenAITexGenSlateToolJob* InJob);
+
+	FString Prompt;
+	FString TextureName;
+	FString ImageSize;
+	FString PackagePath;
+
+	UPROPERTY()
+	TObjectPtr<UOpenAITexGenSlateToolJob> Job;
+};
@@ -0,0 +1,106 @@
+/*
+* Copyright (C) 2023 Akın Kürşat Özkan <akinkursatozkan@gmail.com>
+ * 
+ * This file is part of OpenAITexGenSlateTool
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the MIT License as published by
+ * the Open Source Initiative, either version 1.0 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * MIT License for more details.
+ * 
+ * You should have received a copy of the MIT License
+ * along with this program. If not, see <https://opensource.org/licenses/MIT>.
+ *
+ * Source code on GitHub: https://github.com/aknkrstozkn/OpenAITexGenSlateTool
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "OpenAITexGenSlateToolTypes.h"
+#include "OpenAITexGenSlateToolJob.generated.h"
+
+class UTexture2D;
+class UOpenAITexGenSlateToolJob;
+
+UENUM(BlueprintType)
+enum class EOpenAITexGenSlateToolJobState : uint8
+{
+	Queued,
+	RequestingImage,
+	DownloadingImage,
+	CreatingTexture,
+	Succeeded,
+	Failed
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnOpenAITexGenSlateToolJobProgress, UOpenAITexGenSlateToolJob*, Job, EOpenAITexGenSlateToolJobState, State, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnOpenAITexGenSlateToolJobCompleted, UOpenAITexGenSlateToolJob*, Job, bool, bSuccess, UTexture2D*, Texture);
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnOpenAITexGenSlateToolJobProgressNative, UOpenAITexGenSlateToolJob* /*Job*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnOpenAITexGenSlateToolJobCompletedNative, UOpenAITexGenSlateToolJob* /*Job*/);
+
+/**
+ * Handle to a single texture generation submitted to the module pipeline.
+ * The job keeps itself rooted while in flight, so callers don't need to hold a reference to receive its delegates.
+ */
+UCLASS(BlueprintType)
+class OPENAITEXGENSLATETOOL_API UOpenAITexGenSlateToolJob : public UObject
+{
+	GENERATED_BODY()
+
+	friend class FOpenAITexGenSlateToolModule;
+
+public:
+	UPROPERTY(BlueprintAssignable, Category = TextureGenerator)
+	FOnOpenAITexGenSlateToolJobProgress OnProgress;
+
+	UPROPERTY(BlueprintAssignable, Category = TextureGenerator)
+	FOnOpenAITexGenSlateToolJobCompleted OnCompleted;
+
+	FOnOpenAITexGenSlateToolJobProgressNative OnProgressNative;
+	FOnOpenAITexGenSlateToolJobCompletedNative OnCompletedNative;
+
+	UFUNCTION(BlueprintPure, Category = TextureGenerator)
+	EOpenAITexGenSlateToolJobState GetState() const { return State; }
+
+	UFUNCTION(BlueprintPure, Category = TextureGenerator)
+	float GetProgress() const;
+
+	UFUNCTION(BlueprintPure, Category = TextureGenerator)
+	bool IsFinished() const { return State == EOpenAITexGenSlateToolJobState::Succeeded || State == EOpenAITexGenSlateToolJobState::Failed; }
+
+	UFUNCTION(BlueprintPure, Category = TextureGenerator)
+	UTexture2D* GetTexture() const { return Texture; }
+
+	UFUNCTION(BlueprintPure, Category = TextureGenerator)
+	const FString& GetErrorMessage() const { return ErrorMessage; }
+
+	UFUNCTION(BlueprintPure, Category = TextureGenerator)
+	const FString& GetPrompt() const { return DallEPrompt.Prompt; }
+
+	UFUNCTION(BlueprintPure, Category = TextureGenerator)
+	FString GetAssetPath() const { return PackagePath / TextureName; }
+
+	const FString& GetPackagePath() const { return PackagePath; }
+	const FString& GetTextureName() const { return TextureName; }
+	
+private:
+	void SetState(EOpenAITexGenSlateToolJobState NewState);
+	void Finish(UTexture2D* InTexture, const FString& InErrorMessage);
+
+	FDallEPrompt DallEPrompt;
+	FString PackagePath;
+	FString TextureName;
+	FString ErrorMessage;
+	EOpenAITexGenSlateToolJobState State = EOpenAITexGenSlateToolJobState::Queued;
+
+	UPROPERTY()
+	TObjectPtr<UTexture2D> Texture;
+};
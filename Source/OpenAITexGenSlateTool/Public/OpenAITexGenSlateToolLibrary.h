@@ -0,0 +1,42 @@
+/*
+* Copyright (C) 2023 Akın Kürşat Özkan <akinkursatozkan@gmail.com>
+ * 
+ * This file is part of OpenAITexGenSlateTool
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the MIT License as published by
+ * the Open Source Initiative, either version 1.0 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * MIT License for more details.
+ * 
+ * You should have received a copy of the MIT License
+ * along with this program. If not, see <https://opensource.org/licenses/MIT>.
+ *
+ * Source code on GitHub: https://github.com/aknkrstozkn/OpenAITexGenSlateTool
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "OpenAITexGenSlateToolLibrary.generated.h"
+
+class UOpenAITexGenSlateToolJob;
+
+/**
+ * Script entry points for the texture generator, also exposed to Python as unreal.OpenAITexGenSlateToolLibrary.
+ * Submitting only queues the job, bind to the returned handle's OnProgress/OnCompleted delegates for results.
+ */
+UCLASS()
+class OPENAITEXGENSLATETOOL_API UOpenAITexGenSlateToolLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = TextureGenerator)
+	static UOpenAITexGenSlateToolJob* SubmitTextureGeneration(const FString& Prompt, const FString& TextureName, const FString& ImageSize = TEXT("1024x1024"), const FString& PackagePath = TEXT("/Game"));
+};
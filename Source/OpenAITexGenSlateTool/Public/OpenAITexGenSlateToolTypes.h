@@ -56,3 +56,24 @@ struct FDallEResponse final : FJsonSerializable
 
 	TArray<FURLData> UrlArray;
 };
+
+struct FDallEErrorData final : FJsonSerializable
+{
+	BEGIN_JSON_SERIALIZER
+		JSON_SERIALIZE("message", Message);
+	END_JSON_SERIALIZER
+
+	FString Message;
+};
+
+struct FDallEErrorResponse final : FJsonSerializable
+{
+	// Example Error Format
+	// {"error": {"code": null, "message": "...", "param": null, "type": "invalid_request_error"}}
+	
+	BEGIN_JSON_SERIALIZER
+		JSON_SERIALIZE_OBJECT_SERIALIZABLE("error", Error);
+	END_JSON_SERIALIZER
+
+	FDallEErrorData Error;
+};